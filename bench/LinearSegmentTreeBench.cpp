@@ -0,0 +1,124 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#include "../ds/segment_tree.hpp"
+#include "bench_util.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+    using tree_type = inflate::linear_segment_tree<long long>;
+
+    // A node is ~48 bytes and 4n of them are reserved, so 10^8 would need ~19 GiB
+    constexpr long long max_size = 10'000'000;
+
+    // Operation 0: add a constant to every element of the range
+    void add_range_add(tree_type& tree) {
+        tree.add_operation([](long long a, long long b, size_t begin_pos, size_t end_pos) {
+            return a + b * static_cast<long long>(end_pos - begin_pos);
+        });
+    }
+
+    void BM_LinearSegmentTree_Build(benchmark::State& state) {
+        const auto values = inflate::bench::random_values(state.range(0));
+        for (auto _ : state) {
+            tree_type tree(values.begin(), values.end());
+            benchmark::DoNotOptimize(tree.root_node().sum);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetComplexityN(state.range(0));
+    }
+
+    void BM_LinearSegmentTree_QueryRandom(benchmark::State& state) {
+        const auto values = inflate::bench::random_values(state.range(0));
+        const auto ranges = inflate::bench::random_ranges(state.range(0));
+        tree_type tree(values.begin(), values.end());
+        add_range_add(tree);
+        std::size_t i = 0;
+        for (auto _ : state) {
+            const auto& [l, r] = ranges[i++ % ranges.size()];
+            benchmark::DoNotOptimize(tree.query(l, r));
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetComplexityN(state.range(0));
+    }
+
+    // [1, n - 1) never lines up with a node, so both boundary paths are walked to the leaves
+    void BM_LinearSegmentTree_QueryWorstCase(benchmark::State& state) {
+        const auto values = inflate::bench::random_values(state.range(0));
+        tree_type tree(values.begin(), values.end());
+        add_range_add(tree);
+        const std::size_t n = state.range(0);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(tree.query(1, n - 1));
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetComplexityN(state.range(0));
+    }
+
+    void BM_LinearSegmentTree_UpdateRandom(benchmark::State& state) {
+        const auto values = inflate::bench::random_values(state.range(0));
+        const auto ranges = inflate::bench::random_ranges(state.range(0));
+        tree_type tree(values.begin(), values.end());
+        add_range_add(tree);
+        std::size_t i = 0;
+        for (auto _ : state) {
+            const auto& [l, r] = ranges[i++ % ranges.size()];
+            tree.update(l, r, 0, 1);
+        }
+        benchmark::DoNotOptimize(tree.root_node().sum);
+        state.SetItemsProcessed(state.iterations());
+        state.SetComplexityN(state.range(0));
+    }
+
+    void BM_LinearSegmentTree_UpdatePoint(benchmark::State& state) {
+        const auto values = inflate::bench::random_values(state.range(0));
+        const auto positions = inflate::bench::random_positions(state.range(0));
+        tree_type tree(values.begin(), values.end());
+        add_range_add(tree);
+        std::size_t i = 0;
+        for (auto _ : state) {
+            const auto p = positions[i++ % positions.size()];
+            tree.update(p, p + 1, 0, 1);
+        }
+        benchmark::DoNotOptimize(tree.root_node().sum);
+        state.SetItemsProcessed(state.iterations());
+        state.SetComplexityN(state.range(0));
+    }
+
+    // Alternating a full-range update with a misaligned one leaves a tag on the root that
+    // the next update has to push down along both boundary paths
+    void BM_LinearSegmentTree_UpdateWorstCase(benchmark::State& state) {
+        const auto values = inflate::bench::random_values(state.range(0));
+        tree_type tree(values.begin(), values.end());
+        add_range_add(tree);
+        const std::size_t n = state.range(0);
+        bool full = false;
+        for (auto _ : state) {
+            if (full) {
+                tree.update(0, n, 0, 1);
+            } else {
+                tree.update(1, n - 1, 0, 1);
+            }
+            full = !full;
+        }
+        benchmark::DoNotOptimize(tree.root_node().sum);
+        state.SetItemsProcessed(state.iterations());
+        state.SetComplexityN(state.range(0));
+    }
+
+} // namespace
+
+BENCHMARK(BM_LinearSegmentTree_Build)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oN);
+BENCHMARK(BM_LinearSegmentTree_QueryRandom)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Complexity(benchmark::oLogN);
+BENCHMARK(BM_LinearSegmentTree_QueryWorstCase)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Complexity(benchmark::oLogN);
+BENCHMARK(BM_LinearSegmentTree_UpdateRandom)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Complexity(benchmark::oLogN);
+BENCHMARK(BM_LinearSegmentTree_UpdatePoint)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Complexity(benchmark::oLogN);
+BENCHMARK(BM_LinearSegmentTree_UpdateWorstCase)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Complexity(benchmark::oLogN);
@@ -0,0 +1,63 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#include "../ds/mo_query_engine.hpp"
+#include "bench_util.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+    // O((n + q) * sqrt(n)) per batch; at 10^7 a single batch takes minutes
+    constexpr long long max_size = 1'000'000;
+
+    struct distinct_state {
+        std::vector<int> count = std::vector<int>(1001);
+        int distinct = 0;
+    };
+
+    // One batch of n distinct-count queries over n random values
+    void solve_batch(benchmark::State& state, inflate::mo_order order, std::size_t threads) {
+        const std::size_t n = state.range(0);
+        const auto values = inflate::bench::random_values(n);
+        const inflate::mo_query_engine<long long> engine(values.begin(), values.end());
+
+        std::vector<std::pair<std::size_t, std::size_t>> queries;
+        while (queries.size() < n) {
+            const auto batch = inflate::bench::random_ranges(n, inflate::bench::seed + queries.size());
+            queries.insert(queries.end(), batch.begin(), batch.begin() + std::min(batch.size(), n - queries.size()));
+        }
+
+        for (auto _ : state) {
+            auto results = engine.solve(
+                    queries, distinct_state{},
+                    [](distinct_state& s, long long v) { if (s.count[v]++ == 0) ++s.distinct; },
+                    [](distinct_state& s, long long v) { if (--s.count[v] == 0) --s.distinct; },
+                    [](const distinct_state& s) { return s.distinct; },
+                    order, threads);
+            benchmark::DoNotOptimize(results.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetComplexityN(state.range(0));
+    }
+
+    void BM_MoQueryEngine_Block(benchmark::State& state) {
+        solve_batch(state, inflate::mo_order::block, 1);
+    }
+
+    void BM_MoQueryEngine_Hilbert(benchmark::State& state) {
+        solve_batch(state, inflate::mo_order::hilbert, 1);
+    }
+
+    void BM_MoQueryEngine_HilbertParallel(benchmark::State& state) {
+        solve_batch(state, inflate::mo_order::hilbert, std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+} // namespace
+
+BENCHMARK(BM_MoQueryEngine_Block)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Unit(benchmark::kMillisecond)->Complexity();
+BENCHMARK(BM_MoQueryEngine_Hilbert)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Unit(benchmark::kMillisecond)->Complexity();
+BENCHMARK(BM_MoQueryEngine_HilbertParallel)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Unit(benchmark::kMillisecond)->UseRealTime()->Complexity();
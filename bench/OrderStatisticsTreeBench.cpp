@@ -0,0 +1,137 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#include "../ds/order_statistics_tree.hpp"
+#include "bench_util.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <random>
+
+namespace {
+
+    using tree_type = inflate::order_statistics_tree<long long>;
+
+    // Every element is a separate heap node, so 10^8 would need several GiB and minutes per run
+    constexpr long long max_size = 10'000'000;
+
+    std::vector<long long> shuffled_keys(std::size_t n) {
+        std::vector<long long> keys(n);
+        std::iota(keys.begin(), keys.end(), 0);
+        std::shuffle(keys.begin(), keys.end(), std::mt19937_64(inflate::bench::seed));
+        return keys;
+    }
+
+    std::vector<long long> sorted_keys(std::size_t n) {
+        std::vector<long long> keys(n);
+        std::iota(keys.begin(), keys.end(), 0);
+        return keys;
+    }
+
+    void insert_all(benchmark::State& state, const std::vector<long long>& keys) {
+        std::optional<tree_type> tree;
+        for (auto _ : state) {
+            tree.emplace();
+            for (const auto& key : keys) {
+                tree->insert(key);
+            }
+            benchmark::DoNotOptimize(tree->getSize());
+            // tear down outside the timed region
+            state.PauseTiming();
+            tree.reset();
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetComplexityN(state.range(0));
+    }
+
+    void remove_all(benchmark::State& state, const std::vector<long long>& insert_order,
+                    const std::vector<long long>& remove_order) {
+        for (auto _ : state) {
+            state.PauseTiming();
+            tree_type tree;
+            for (const auto& key : insert_order) {
+                tree.insert(key);
+            }
+            state.ResumeTiming();
+            for (const auto& key : remove_order) {
+                tree.remove(key);
+            }
+            benchmark::DoNotOptimize(tree.getSize());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetComplexityN(state.range(0));
+    }
+
+    void BM_OrderStatisticsTree_InsertRandom(benchmark::State& state) {
+        insert_all(state, shuffled_keys(state.range(0)));
+    }
+
+    // Ascending keys always land on the right spine and trigger a rebalance on almost every insert
+    void BM_OrderStatisticsTree_InsertSorted(benchmark::State& state) {
+        insert_all(state, sorted_keys(state.range(0)));
+    }
+
+    void BM_OrderStatisticsTree_RemoveRandom(benchmark::State& state) {
+        const auto keys = shuffled_keys(state.range(0));
+        auto remove_order = keys;
+        std::shuffle(remove_order.begin(), remove_order.end(), std::mt19937_64(inflate::bench::seed + 1));
+        remove_all(state, keys, remove_order);
+    }
+
+    // Always removing the minimum keeps draining the same side of the tree
+    void BM_OrderStatisticsTree_RemoveSorted(benchmark::State& state) {
+        remove_all(state, shuffled_keys(state.range(0)), sorted_keys(state.range(0)));
+    }
+
+    void BM_OrderStatisticsTree_KthSmallestRandom(benchmark::State& state) {
+        tree_type tree;
+        for (const auto& key : shuffled_keys(state.range(0))) {
+            tree.insert(key);
+        }
+        std::vector<int> ks(inflate::bench::batch_size);
+        std::mt19937 gen(inflate::bench::seed);
+        std::uniform_int_distribution<int> dist(1, tree.getSize());
+        for (auto& k : ks) {
+            k = dist(gen);
+        }
+        std::size_t i = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(tree.kthSmallest(ks[i++ % ks.size()]));
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetComplexityN(state.range(0));
+    }
+
+    // Sorted inserts produce the deepest legal red-black shape; alternate between its two extremes
+    void BM_OrderStatisticsTree_KthSmallestWorstCase(benchmark::State& state) {
+        tree_type tree;
+        for (const auto& key : sorted_keys(state.range(0))) {
+            tree.insert(key);
+        }
+        const int n = tree.getSize();
+        bool first = false;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(tree.kthSmallest(first ? 1 : n));
+            first = !first;
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetComplexityN(state.range(0));
+    }
+
+} // namespace
+
+BENCHMARK(BM_OrderStatisticsTree_InsertRandom)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oNLogN);
+BENCHMARK(BM_OrderStatisticsTree_InsertSorted)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oNLogN);
+BENCHMARK(BM_OrderStatisticsTree_RemoveRandom)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oNLogN);
+BENCHMARK(BM_OrderStatisticsTree_RemoveSorted)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oNLogN);
+BENCHMARK(BM_OrderStatisticsTree_KthSmallestRandom)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Complexity(benchmark::oLogN);
+BENCHMARK(BM_OrderStatisticsTree_KthSmallestWorstCase)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Complexity(benchmark::oLogN);
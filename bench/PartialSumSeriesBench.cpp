@@ -0,0 +1,62 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#include "../ds/partial_sum_series.hpp"
+#include "bench_util.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+    using series_type = inflate::partial_sum_series<long long>;
+
+    constexpr long long max_size = 100'000'000;
+
+    void BM_PartialSumSeries_Build(benchmark::State& state) {
+        const auto values = inflate::bench::random_values(state.range(0));
+        for (auto _ : state) {
+            series_type series(values.begin(), values.end());
+            benchmark::DoNotOptimize(series.underlying_container.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<long long>(sizeof(long long)));
+        state.SetComplexityN(state.range(0));
+    }
+
+    void BM_PartialSumSeries_QueryRandom(benchmark::State& state) {
+        const auto values = inflate::bench::random_values(state.range(0));
+        const auto ranges = inflate::bench::random_ranges(state.range(0));
+        const series_type series(values.begin(), values.end());
+        std::size_t i = 0;
+        for (auto _ : state) {
+            const auto& [l, r] = ranges[i++ % ranges.size()];
+            benchmark::DoNotOptimize(series.query(series.cbegin() + l, series.cbegin() + r - 1));
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetComplexityN(state.range(0));
+    }
+
+    // Both endpoints sit n / 2 apart and jump by a large odd stride, so every lookup misses cache
+    void BM_PartialSumSeries_QueryScattered(benchmark::State& state) {
+        const auto values = inflate::bench::random_values(state.range(0));
+        const series_type series(values.begin(), values.end());
+        const std::size_t n = state.range(0);
+        const std::size_t half = n / 2;
+        const std::size_t stride = 4099;
+        std::size_t l = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(series.query_n(series.cbegin() + l, half));
+            l = (l + stride) % (n - half);
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetComplexityN(state.range(0));
+    }
+
+} // namespace
+
+BENCHMARK(BM_PartialSumSeries_Build)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oN);
+BENCHMARK(BM_PartialSumSeries_QueryRandom)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Complexity(benchmark::o1);
+BENCHMARK(BM_PartialSumSeries_QueryScattered)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Complexity(benchmark::o1);
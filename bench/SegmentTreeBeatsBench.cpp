@@ -0,0 +1,83 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#include "../ds/segment_tree_beats.hpp"
+#include "bench_util.hpp"
+#include <benchmark/benchmark.h>
+#include <optional>
+
+namespace {
+
+    using tree_type = inflate::segment_tree_beats<long long>;
+
+    // Same 4n reservation as linear_segment_tree, with ~72-byte nodes
+    constexpr long long max_size = 10'000'000;
+
+    void BM_SegmentTreeBeats_Build(benchmark::State& state) {
+        const auto values = inflate::bench::random_values(state.range(0));
+        for (auto _ : state) {
+            tree_type tree(values.begin(), values.end());
+            benchmark::DoNotOptimize(tree.root_node().sum);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetComplexityN(state.range(0));
+    }
+
+    // Random clamps interleaved with the sum queries that read them back
+    void BM_SegmentTreeBeats_ChminQueryRandom(benchmark::State& state) {
+        const auto values = inflate::bench::random_values(state.range(0));
+        const auto ranges = inflate::bench::random_ranges(state.range(0));
+        const auto bounds = inflate::bench::random_values(inflate::bench::batch_size, inflate::bench::seed + 1);
+        tree_type tree(values.begin(), values.end());
+        std::size_t i = 0;
+        for (auto _ : state) {
+            const auto& [l, r] = ranges[i % ranges.size()];
+            if (i % 2 == 0) {
+                tree.chmin(l, r, bounds[i % bounds.size()]);
+            } else {
+                benchmark::DoNotOptimize(tree.query_sum(l, r));
+            }
+            ++i;
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetComplexityN(state.range(0));
+    }
+
+    // Alternating chmin and chmax on random sub-ranges with random bounds. Clamps keep merging
+    // extrema groups, so the tree is rebuilt from the original values (untimed) after every batch
+    // to stop the run from collapsing into the trivial all-equal case
+    void BM_SegmentTreeBeats_ChminChmaxAlternating(benchmark::State& state) {
+        const auto values = inflate::bench::random_values(state.range(0));
+        const auto ranges = inflate::bench::random_ranges(state.range(0));
+        const auto bounds = inflate::bench::random_values(inflate::bench::batch_size, inflate::bench::seed + 1);
+        std::optional<tree_type> tree(std::in_place, values.begin(), values.end());
+        std::size_t i = 0;
+        for (auto _ : state) {
+            if (i == inflate::bench::batch_size) {
+                state.PauseTiming();
+                tree.emplace(values.begin(), values.end());
+                i = 0;
+                state.ResumeTiming();
+            }
+            const auto& [l, r] = ranges[i];
+            if (i % 2 == 0) {
+                tree->chmin(l, r, bounds[i]);
+            } else {
+                tree->chmax(l, r, bounds[i]);
+            }
+            ++i;
+        }
+        benchmark::DoNotOptimize(tree->root_node().sum);
+        state.SetItemsProcessed(state.iterations());
+        state.SetComplexityN(state.range(0));
+    }
+
+} // namespace
+
+BENCHMARK(BM_SegmentTreeBeats_Build)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oN);
+BENCHMARK(BM_SegmentTreeBeats_ChminQueryRandom)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Complexity(benchmark::oLogN);
+BENCHMARK(BM_SegmentTreeBeats_ChminChmaxAlternating)
+    ->RangeMultiplier(10)->Range(1'000, max_size)->Complexity(benchmark::oLogN);
@@ -0,0 +1,65 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#include "../ds/sharded_segment_tree.hpp"
+#include "bench_util.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+    using tree_type = inflate::sharded_segment_tree<long long>;
+
+    constexpr std::size_t size = 1'000'000;
+    constexpr std::size_t shards = 64;
+
+    std::unique_ptr<tree_type> tree;
+
+    void setup(const benchmark::State&) {
+        const auto values = inflate::bench::random_values(size);
+        tree = std::make_unique<tree_type>(values.begin(), values.end(), shards);
+        tree->add_operation([](long long a, long long b, size_t begin_pos, size_t end_pos) {
+            return a + b * static_cast<long long>(end_pos - begin_pos);
+        });
+    }
+
+    void teardown(const benchmark::State&) {
+        tree.reset();
+    }
+
+    // Each thread writes only inside its own slice of the index space
+    void BM_ShardedSegmentTree_UpdateDisjoint(benchmark::State& state) {
+        const std::size_t width = size / state.threads();
+        const std::size_t offset = width * state.thread_index();
+        const auto ranges = inflate::bench::random_ranges(width, inflate::bench::seed + state.thread_index());
+        std::size_t i = 0;
+        for (auto _ : state) {
+            const auto& [l, r] = ranges[i++ % ranges.size()];
+            tree->update(offset + l, offset + r, 0, 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Every thread writes anywhere, so shards are contended
+    void BM_ShardedSegmentTree_UpdateRandom(benchmark::State& state) {
+        const auto ranges = inflate::bench::random_ranges(size, inflate::bench::seed + state.thread_index());
+        std::size_t i = 0;
+        for (auto _ : state) {
+            const auto& [l, r] = ranges[i++ % ranges.size()];
+            tree->update(l, r, 0, 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_ShardedSegmentTree_QueryTotal(benchmark::State& state) {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(tree->query(0, size));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+} // namespace
+
+BENCHMARK(BM_ShardedSegmentTree_UpdateDisjoint)->Setup(setup)->Teardown(teardown)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ShardedSegmentTree_UpdateRandom)->Setup(setup)->Teardown(teardown)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ShardedSegmentTree_QueryTotal)->Setup(setup)->Teardown(teardown)->ThreadRange(1, 16)->UseRealTime();
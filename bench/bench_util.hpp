@@ -0,0 +1,59 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#ifndef INFLATE_BENCH_UTIL_HPP
+#define INFLATE_BENCH_UTIL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace inflate::bench {
+
+    // Every generator is seeded with a fixed value so two runs see the same workload
+    inline constexpr std::uint_fast32_t seed = 20231018;
+
+    // Number of pre-generated operations each benchmark cycles through
+    inline constexpr std::size_t batch_size = 1 << 16;
+
+    inline std::vector<long long> random_values(std::size_t n, std::uint_fast32_t s = seed) {
+        std::mt19937 gen(s);
+        std::uniform_int_distribution<long long> dist(0, 1000);
+        std::vector<long long> values(n);
+        for (auto& v : values) {
+            v = dist(gen);
+        }
+        return values;
+    }
+
+    // Non-empty half-open ranges [l, r) inside [0, n)
+    inline std::vector<std::pair<std::size_t, std::size_t>> random_ranges(std::size_t n,
+                                                                          std::uint_fast32_t s = seed) {
+        std::mt19937_64 gen(s);
+        std::uniform_int_distribution<std::size_t> dist(0, n - 1);
+        std::vector<std::pair<std::size_t, std::size_t>> ranges(batch_size);
+        for (auto& [l, r] : ranges) {
+            auto a = dist(gen), b = dist(gen);
+            if (a > b) std::swap(a, b);
+            l = a;
+            r = b + 1;
+        }
+        return ranges;
+    }
+
+    inline std::vector<std::size_t> random_positions(std::size_t n, std::uint_fast32_t s = seed) {
+        std::mt19937_64 gen(s);
+        std::uniform_int_distribution<std::size_t> dist(0, n - 1);
+        std::vector<std::size_t> positions(batch_size);
+        for (auto& p : positions) {
+            p = dist(gen);
+        }
+        return positions;
+    }
+
+} // inflate::bench
+
+#endif //INFLATE_BENCH_UTIL_HPP
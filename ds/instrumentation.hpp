@@ -0,0 +1,84 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#ifndef INFLATE_INSTRUMENTATION_HPP
+#define INFLATE_INSTRUMENTATION_HPP
+
+#include <concepts>
+#include <cstddef>
+
+namespace inflate {
+
+    struct instrumentation_snapshot {
+        std::size_t node_visits = 0;
+        std::size_t push_downs = 0;
+        std::size_t rotations = 0;
+        std::size_t allocations = 0;
+        std::size_t bytes_allocated = 0;
+
+        constexpr instrumentation_snapshot& operator+=(const instrumentation_snapshot& other) noexcept {
+            node_visits += other.node_visits;
+            push_downs += other.push_downs;
+            rotations += other.rotations;
+            allocations += other.allocations;
+            bytes_allocated += other.bytes_allocated;
+            return *this;
+        }
+
+        constexpr bool operator==(const instrumentation_snapshot&) const noexcept = default;
+    };
+
+    // Hot-path hooks every container calls; a policy decides what, if anything, they record
+    template <class I>
+    concept instrumentation_policy = std::default_initializable<I>
+                                     && requires(I i, const I ci, std::size_t bytes) {
+                                         {i.on_node_visit()};
+                                         {i.on_push_down()};
+                                         {i.on_rotation()};
+                                         {i.on_allocation(bytes)};
+                                         {i.reset()};
+                                         {ci.snapshot()} -> std::convertible_to<instrumentation_snapshot>;
+                                     };
+
+    // Default policy. Empty, so with [[no_unique_address]] it adds neither storage nor instructions
+    struct no_instrumentation {
+        constexpr void on_node_visit() noexcept {}
+        constexpr void on_push_down() noexcept {}
+        constexpr void on_rotation() noexcept {}
+        constexpr void on_allocation(std::size_t) noexcept {}
+        constexpr void reset() noexcept {}
+
+        [[nodiscard]] constexpr instrumentation_snapshot snapshot() const noexcept {
+            return {};
+        }
+    };
+
+    // Plain per-instance counters; like the containers themselves, not thread safe
+    struct counting_instrumentation {
+        instrumentation_snapshot counters;
+
+        constexpr void on_node_visit() noexcept { ++counters.node_visits; }
+        constexpr void on_push_down() noexcept { ++counters.push_downs; }
+        constexpr void on_rotation() noexcept { ++counters.rotations; }
+
+        constexpr void on_allocation(std::size_t bytes) noexcept {
+            ++counters.allocations;
+            counters.bytes_allocated += bytes;
+        }
+
+        constexpr void reset() noexcept {
+            counters = {};
+        }
+
+        [[nodiscard]] constexpr instrumentation_snapshot snapshot() const noexcept {
+            return counters;
+        }
+    };
+
+    static_assert(instrumentation_policy<no_instrumentation>);
+    static_assert(instrumentation_policy<counting_instrumentation>);
+
+} // inflate
+
+#endif //INFLATE_INSTRUMENTATION_HPP
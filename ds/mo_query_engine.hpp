@@ -0,0 +1,179 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#ifndef INFLATE_MO_QUERY_ENGINE_HPP
+#define INFLATE_MO_QUERY_ENGINE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace inflate {
+
+    enum class mo_order { block, hilbert };
+
+    /*
+     * Offline range statistics with Mo's algorithm, for answers that cannot be merged from two
+     * halves (distinct count, mode frequency, ...).
+     *
+     * The caller describes a sliding window: a State, add(state, value) and remove(state, value)
+     * to grow or shrink it by one element, and answer(state) to read the current result. Queries
+     * [l, r) are reordered so the window endpoints move O((n + q) * sqrt(n)) steps in total, either
+     * by sqrt-sized blocks of l or along a Hilbert curve over (l, r), which usually moves less.
+     *
+     * With threads > 1 the ordered queries are cut into that many contiguous runs, each walked by
+     * its own copy of the initial state and of the callbacks. Every run pays up to O(n) to move
+     * its window into place, and the callbacks must not share mutable state.
+     */
+    template <std::copyable T>
+    class mo_query_engine {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using query_type = std::pair<size_type, size_type>;
+    protected:
+        std::vector<T> values;
+
+        static std::uint64_t hilbert_index(std::uint64_t x, std::uint64_t y, std::uint64_t n) noexcept {
+            std::uint64_t d = 0;
+            for (std::uint64_t s = n / 2; s > 0; s /= 2) {
+                bool rx = (x & s) != 0;
+                bool ry = (y & s) != 0;
+                d += s * s * ((3 * rx) ^ ry);
+                if (!ry) {
+                    if (rx) {
+                        x = n - 1 - x;
+                        y = n - 1 - y;
+                    }
+                    std::swap(x, y);
+                }
+            }
+            return d;
+        }
+
+        std::vector<size_type> order_queries(const std::vector<query_type>& queries, mo_order order) const {
+            std::vector<size_type> permutation(queries.size());
+            std::iota(permutation.begin(), permutation.end(), 0);
+
+            if (order == mo_order::hilbert) {
+                const std::uint64_t side = std::bit_ceil(values.size() + 1);
+                std::vector<std::uint64_t> keys(queries.size());
+                for (size_type i = 0; i < queries.size(); ++i) {
+                    keys[i] = hilbert_index(queries[i].first, queries[i].second, side);
+                }
+                std::sort(permutation.begin(), permutation.end(),
+                          [&](size_type a, size_type b) { return keys[a] < keys[b]; });
+            } else {
+                const size_type block = std::max<size_type>(
+                        1, values.size() / std::max<size_type>(1, std::sqrt(static_cast<double>(queries.size()))));
+                // Odd blocks sweep r backwards so r does not rewind at every block boundary
+                std::sort(permutation.begin(), permutation.end(), [&](size_type a, size_type b) {
+                    const auto& [la, ra] = queries[a];
+                    const auto& [lb, rb] = queries[b];
+                    if (la / block != lb / block) {
+                        return la / block < lb / block;
+                    }
+                    return (la / block) % 2 == 0 ? ra < rb : ra > rb;
+                });
+            }
+            return permutation;
+        }
+
+        template<class State, class Add, class Remove, class Answer, std::random_access_iterator Out>
+        void solve_run(const std::vector<query_type>& queries,
+                       const size_type* begin, const size_type* end,
+                       State state, Add add, Remove remove, Answer answer,
+                       Out results) const {
+            size_type cur_l = 0, cur_r = 0;
+            for (; begin != end; ++begin) {
+                const auto& [l, r] = queries[*begin];
+                while (cur_l > l) std::invoke(add, state, values[--cur_l]);
+                while (cur_r < r) std::invoke(add, state, values[cur_r++]);
+                while (cur_l < l) std::invoke(remove, state, values[cur_l++]);
+                while (cur_r > r) std::invoke(remove, state, values[--cur_r]);
+                results[*begin] = std::invoke(answer, std::as_const(state));
+            }
+        }
+
+    public:
+
+        template<std::input_iterator Iter>
+        mo_query_engine(Iter begin, Iter end): values(begin, end) {}
+
+        [[nodiscard]] constexpr size_type size() const noexcept {
+            return values.size();
+        }
+
+        template<class State, class Add, class Remove, class Answer>
+        requires std::copyable<State>
+                 && std::copy_constructible<Add> && std::copy_constructible<Remove> && std::copy_constructible<Answer>
+                 && std::invocable<Add&, State&, const T&>
+                 && std::invocable<Remove&, State&, const T&>
+                 && std::invocable<Answer&, const State&>
+                 && std::default_initializable<std::invoke_result_t<Answer&, const State&>>
+        auto solve(const std::vector<query_type>& queries, const State& initial,
+                   Add add, Remove remove, Answer answer,
+                   mo_order order = mo_order::hilbert, size_type threads = 1) const {
+            using result_type = std::invoke_result_t<Answer&, const State&>;
+
+            for (const auto& [l, r] : queries) {
+                if (l > r || r > values.size())
+                    throw std::out_of_range("Invalid query range!");
+            }
+
+            const auto permutation = order_queries(queries, order);
+
+            threads = std::clamp<size_type>(threads, 1, std::max<size_type>(queries.size(), 1));
+            if (threads == 1) {
+                std::vector<result_type> results(queries.size());
+                solve_run(queries, permutation.data(), permutation.data() + permutation.size(),
+                          initial, add, remove, answer, results.begin());
+                return results;
+            }
+
+            // Runs write disjoint result slots, so the only synchronization is the join. The slots
+            // live in a plain array because std::vector<bool> packs neighbouring slots into one word
+            auto buffer = std::make_unique<result_type[]>(queries.size());
+            const size_type run = (permutation.size() + threads - 1) / threads;
+            std::vector<std::exception_ptr> errors(threads);
+            {
+                std::vector<std::jthread> workers;
+                workers.reserve(threads);
+                for (size_type begin = 0, i = 0; begin < permutation.size(); begin += run, ++i) {
+                    const size_type end = std::min(begin + run, permutation.size());
+                    workers.emplace_back([&, begin, end, i] {
+                        try {
+                            solve_run(queries, permutation.data() + begin, permutation.data() + end,
+                                      initial, add, remove, answer, buffer.get());
+                        } catch (...) {
+                            errors[i] = std::current_exception();
+                        }
+                    });
+                }
+            }
+
+            // Surface a callback exception the same way the single-threaded path does
+            for (const auto& error : errors) {
+                if (error)
+                    std::rethrow_exception(error);
+            }
+            return std::vector<result_type>(std::make_move_iterator(buffer.get()),
+                                            std::make_move_iterator(buffer.get() + queries.size()));
+        }
+    };
+
+} // inflate
+
+#endif //INFLATE_MO_QUERY_ENGINE_HPP
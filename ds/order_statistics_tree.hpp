@@ -14,6 +14,8 @@
 #include <algorithm>
 #include <concepts>
 
+#include "instrumentation.hpp"
+
 namespace inflate {
 
     enum class Color { RED, BLACK };
@@ -31,10 +33,12 @@ namespace inflate {
                 : value(val), parent(nullptr), left(nullptr), right(nullptr), color(col), size(1) {}
     };
 
-    template <std::copyable T>
+    template <std::copyable T, class Instrumentation = no_instrumentation>
+    requires instrumentation_policy<Instrumentation>
     class order_statistics_tree {
     public:
         using value_type = T;
+        using instrumentation_type = Instrumentation;
 
         order_statistics_tree() : root(nullptr) {}
 
@@ -43,9 +47,9 @@ namespace inflate {
         }
 
         void insert(const T& value) {
-            auto* new_node = new rb_tree_node<T>(value);
-            BSTInsert(new_node);
-            fixViolation(new_node);
+            auto* new_node = BSTInsert(value);
+            if (new_node != nullptr)
+                fixViolation(new_node);
         }
 
         void remove(const T& value) {
@@ -74,12 +78,22 @@ namespace inflate {
             return root->size;
         }
 
+        [[nodiscard]] constexpr instrumentation_snapshot stats() const noexcept {
+            return instrumentation.snapshot();
+        }
+
+        constexpr void reset_stats() noexcept {
+            instrumentation.reset();
+        }
+
     private:
         rb_tree_node<T>* root;
+        [[no_unique_address]] mutable Instrumentation instrumentation;
 
         rb_tree_node<T>* findNode(const T& value) const {
             rb_tree_node<T>* curr = root;
             while (curr != nullptr) {
+                instrumentation.on_node_visit();
                 if (value < curr->value)
                     curr = curr->left;
                 else if (value > curr->value)
@@ -100,7 +114,7 @@ namespace inflate {
             if (node == nullptr)
                 return 0;
 
-            return 1 + calculateSize(node->left) + calculateSize(node->right);
+            return node->size;
         }
 
         void fixViolation(rb_tree_node<T>* node) {
@@ -166,6 +180,7 @@ namespace inflate {
             // Update the size values
             temp->size = node->size;
             node->size = calculateSize(node->left) + calculateSize(node->right) + 1;
+            instrumentation.on_rotation();
         }
 
         void rotateRight(rb_tree_node<T>* node) {
@@ -186,38 +201,43 @@ namespace inflate {
             // Update the size values
             temp->size = node->size;
             node->size = calculateSize(node->left) + calculateSize(node->right) + 1;
+            instrumentation.on_rotation();
         }
 
-        void BSTInsert(rb_tree_node<T>* node) {
+        // Returns the new node, or nullptr if value is already present
+        rb_tree_node<T>* BSTInsert(const T& value) {
             rb_tree_node<T>* x = root;
             rb_tree_node<T>* y = nullptr;
             while (x != nullptr) {
+                instrumentation.on_node_visit();
                 y = x;
-                if (node->value < x->value) {
+                if (value < x->value) {
                     x->size++;
                     x = x->left;
-                } else if (node->value > x->value) {
+                } else if (value > x->value) {
                     x->size++;
                     x = x->right;
                 } else {
-                    return; // Duplicate value, do nothing
+                    // Duplicate value, roll back the sizes bumped on the way down
+                    fixSizeDecrement(x->parent);
+                    return nullptr;
                 }
             }
+            auto* node = new rb_tree_node<T>(value);
+            instrumentation.on_allocation(sizeof(rb_tree_node<T>));
             node->parent = y;
             if (y == nullptr)
                 root = node;
-            else if (node->value < y->value) {
+            else if (value < y->value)
                 y->left = node;
-                fixSizeIncrement(y->right);
-            } else {
+            else
                 y->right = node;
-                fixSizeIncrement(y->left);
-            }
+            return node;
         }
 
-        void fixSizeIncrement(rb_tree_node<T>* node) {
+        void fixSizeDecrement(rb_tree_node<T>* node) {
             while (node != nullptr) {
-                node->size++;
+                node->size--;
                 node = node->parent;
             }
         }
@@ -225,86 +245,95 @@ namespace inflate {
         void BSTRemove(rb_tree_node<T>* node) {
             rb_tree_node<T>* y = node;
             rb_tree_node<T>* x = nullptr;
+            rb_tree_node<T>* x_parent = nullptr;
             Color y_original_color = y->color;
             if (node->left == nullptr) {
                 x = node->right;
+                x_parent = node->parent;
+                fixSizeDecrement(node->parent);
                 transplant(node, node->right);
             } else if (node->right == nullptr) {
                 x = node->left;
+                x_parent = node->parent;
+                fixSizeDecrement(node->parent);
                 transplant(node, node->left);
             } else {
                 y = minimum(node->right);
                 y_original_color = y->color;
                 x = y->right;
-                if (y->parent == node && x != nullptr) {
-                    x->parent = y;
-                    fixSizeDecrement(y->right);
+                // Every ancestor of the spliced-out successor loses one descendant, node included
+                fixSizeDecrement(y->parent);
+                if (y->parent == node) {
+                    x_parent = y;
                 } else {
+                    x_parent = y->parent;
                     transplant(y, y->right);
                     y->right = node->right;
-                    if (y->right != nullptr)
-                        y->right->parent = y;
+                    y->right->parent = y;
                 }
                 transplant(node, y);
                 y->left = node->left;
                 y->left->parent = y;
                 y->color = node->color;
-                fixSizeDecrement(y->left);
+                y->size = node->size;
             }
             if (y_original_color == Color::BLACK)
-                fixViolationRemove(x);
+                fixViolationRemove(x, x_parent);
         }
 
-        void fixViolationRemove(rb_tree_node<T>* node) {
+        // node may be nullptr (a black leaf), so its parent is tracked separately
+        void fixViolationRemove(rb_tree_node<T>* node, rb_tree_node<T>* parent) {
             while (node != root && (node == nullptr || node->color == Color::BLACK)) {
-                if (node == node->parent->left) {
-                    rb_tree_node<T>* sibling = node->parent->right;
+                if (node == parent->left) {
+                    rb_tree_node<T>* sibling = parent->right;
                     if (sibling->color == Color::RED) {
                         sibling->color = Color::BLACK;
-                        node->parent->color = Color::RED;
-                        rotateLeft(node->parent);
-                        sibling = node->parent->right;
+                        parent->color = Color::RED;
+                        rotateLeft(parent);
+                        sibling = parent->right;
                     }
                     if ((sibling->left == nullptr || sibling->left->color == Color::BLACK) &&
                         (sibling->right == nullptr || sibling->right->color == Color::BLACK)) {
                         sibling->color = Color::RED;
-                        node = node->parent;
+                        node = parent;
+                        parent = node->parent;
                     } else {
                         if (sibling->right == nullptr || sibling->right->color == Color::BLACK) {
                             sibling->left->color = Color::BLACK;
                             sibling->color = Color::RED;
                             rotateRight(sibling);
-                            sibling = node->parent->right;
+                            sibling = parent->right;
                         }
-                        sibling->color = node->parent->color;
-                        node->parent->color = Color::BLACK;
+                        sibling->color = parent->color;
+                        parent->color = Color::BLACK;
                         sibling->right->color = Color::BLACK;
-                        rotateLeft(node->parent);
+                        rotateLeft(parent);
                         node = root;
                     }
                 } else {
-                    rb_tree_node<T>* sibling = node->parent->left;
+                    rb_tree_node<T>* sibling = parent->left;
                     if (sibling->color == Color::RED) {
                         sibling->color = Color::BLACK;
-                        node->parent->color = Color::RED;
-                        rotateRight(node->parent);
-                        sibling = node->parent->left;
+                        parent->color = Color::RED;
+                        rotateRight(parent);
+                        sibling = parent->left;
                     }
                     if ((sibling->right == nullptr || sibling->right->color == Color::BLACK) &&
                         (sibling->left == nullptr || sibling->left->color == Color::BLACK)) {
                         sibling->color = Color::RED;
-                        node = node->parent;
+                        node = parent;
+                        parent = node->parent;
                     } else {
                         if (sibling->left == nullptr || sibling->left->color == Color::BLACK) {
                             sibling->right->color = Color::BLACK;
                             sibling->color = Color::RED;
                             rotateLeft(sibling);
-                            sibling = node->parent->left;
+                            sibling = parent->left;
                         }
-                        sibling->color = node->parent->color;
-                        node->parent->color = Color::BLACK;
+                        sibling->color = parent->color;
+                        parent->color = Color::BLACK;
                         sibling->left->color = Color::BLACK;
-                        rotateRight(node->parent);
+                        rotateRight(parent);
                         node = root;
                     }
                 }
@@ -326,6 +355,7 @@ namespace inflate {
         }
 
         T kthSmallestHelper(rb_tree_node<T>* node, int k) const {
+            instrumentation.on_node_visit();
             int leftSize = calculateSize(node->left) + 1;
             if (k == leftSize)
                 return node->value;
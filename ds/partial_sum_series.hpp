@@ -12,15 +12,20 @@
 #include <iterator>
 #include <numeric>
 
+#include "instrumentation.hpp"
+
 namespace inflate {
-    template<class T, class Plus = std::plus<T>, class Minus = std::minus<T>>
+    template<class T, class Plus = std::plus<T>, class Minus = std::minus<T>, class Instrumentation = no_instrumentation>
+    requires instrumentation_policy<Instrumentation>
     class partial_sum_series {
     protected:
         Plus plus;
         Minus minus;
+        [[no_unique_address]] mutable Instrumentation instrumentation;
     public:
         std::vector<T> underlying_container;
         using size_type = std::size_t;
+        using instrumentation_type = Instrumentation;
 
         template<std::input_iterator Iter>
         explicit partial_sum_series(Iter begin, Iter end, const Plus& _plus = Plus(), const Minus& _minus = Minus())
@@ -29,6 +34,15 @@ namespace inflate {
                 underlying_container.reserve(std::distance(begin, end));
             }
             std::partial_sum(begin, end, std::back_inserter(underlying_container), plus);
+            instrumentation.on_allocation(underlying_container.capacity() * sizeof(T));
+        }
+
+        [[nodiscard]] constexpr instrumentation_snapshot stats() const noexcept {
+            return instrumentation.snapshot();
+        }
+
+        constexpr void reset_stats() noexcept {
+            instrumentation.reset();
         }
 
         constexpr decltype(auto) begin() noexcept {
@@ -66,11 +80,15 @@ namespace inflate {
 
         constexpr T query(decltype(underlying_container)::const_iterator begin,
                           decltype(underlying_container)::const_iterator end) const {
-            return std::invoke(minus, *end, *minus);
+            instrumentation.on_node_visit();
+            instrumentation.on_node_visit();
+            return std::invoke(minus, *end, *begin);
         }
 
         constexpr T query_n(decltype(underlying_container)::const_iterator begin,
                             size_type n) const {
+            instrumentation.on_node_visit();
+            instrumentation.on_node_visit();
             return std::invoke(minus, begin[n], *begin);
         }
     };
@@ -11,6 +11,8 @@
 #include <optional>
 #include <numeric>
 
+#include "instrumentation.hpp"
+
 namespace inflate {
 
     template <class T, class OperationOperandType = T>
@@ -78,9 +80,11 @@ namespace inflate {
             class T,
             class Plus = std::plus<T>,
             class OperationOperandType = T,
-            class Alloc = std::allocator<segment_tree_node<T, OperationOperandType>>
+            class Alloc = std::allocator<segment_tree_node<T, OperationOperandType>>,
+            class Instrumentation = no_instrumentation
                     >
             requires linear_segment_tree_requirement<T, Plus, OperationOperandType, Alloc>
+                     && instrumentation_policy<Instrumentation>
 
     class linear_segment_tree {
     public:
@@ -89,11 +93,13 @@ namespace inflate {
         using size_type = std::size_t;
         using allocator_type = Alloc;
         using node_type = segment_tree_node<T, OperationOperandType>;
+        using instrumentation_type = Instrumentation;
     protected:
         Alloc allocator;
         size_type _size;
         node_type* root;
         std::vector<std::function<T(const T&, const OperationOperandType&, size_t begin_pos, size_t end_pos)>> operations;
+        [[no_unique_address]] mutable Instrumentation instrumentation;
 
         template<std::input_iterator Iter>
         Iter buildTree(size_type pos, size_type l, size_type r, Iter begin, Iter end);
@@ -134,10 +140,19 @@ namespace inflate {
             return *root;
         }
 
+        [[nodiscard]] constexpr instrumentation_snapshot stats() const noexcept {
+            return instrumentation.snapshot();
+        }
+
+        constexpr void reset_stats() noexcept {
+            instrumentation.reset();
+        }
+
         template<std::input_iterator Iter>
         constexpr linear_segment_tree(Iter begin, Iter end, const Alloc& alloc = Alloc()):
         _size(std::distance(begin, end)), allocator(alloc){
             root = allocator.allocate(allocation_size());
+            instrumentation.on_allocation(allocation_size() * sizeof(node_type));
             buildTree(1, 0, _size, begin, end);
         };
 
@@ -147,6 +162,7 @@ namespace inflate {
                     other.get_allocator()
                     )) {
             root = allocator.allocate(allocation_size());
+            instrumentation.on_allocation(allocation_size() * sizeof(node_type));
             std::uninitialized_copy_n(other.root, other.allocation_size(), root);
         }
 
@@ -180,6 +196,7 @@ namespace inflate {
             const auto& tag = node._tag.value();
 
             if (not node.is_leaf()) {
+                instrumentation.on_push_down();
                 push_down_tag(pos * 2);
                 push_down_tag(pos * 2 + 1);
                 _apply_op(root[pos * 2 - 1], tag.operation, tag.val);
@@ -194,6 +211,7 @@ namespace inflate {
     private:
 
         void _update(size_type pos, size_type begin, size_type end, size_type operation_num, const OperationOperandType& val) {
+            instrumentation.on_node_visit();
             push_down_tag(pos);
             auto& node = root[pos - 1];
             const auto& operation = operations[operation_num];
@@ -216,6 +234,7 @@ namespace inflate {
         }
 
         T _query(size_type pos, size_type begin_pos, size_type end_pos, const Plus& plus = Plus()) {
+            instrumentation.on_node_visit();
             push_down_tag(pos);
             auto& node = root[pos - 1];
 
@@ -242,10 +261,11 @@ namespace inflate {
         }
     };
 
-    template<class T, class Plus, class OperationOperandType, class Alloc>
+    template<class T, class Plus, class OperationOperandType, class Alloc, class Instrumentation>
     requires linear_segment_tree_requirement<T, Plus, OperationOperandType, Alloc>
+             && instrumentation_policy<Instrumentation>
     template<std::input_iterator Iter>
-    Iter linear_segment_tree<T, Plus, OperationOperandType, Alloc>
+    Iter linear_segment_tree<T, Plus, OperationOperandType, Alloc, Instrumentation>
             ::buildTree(size_type pos, size_type l, size_type r, Iter begin, Iter end) {
         if (l == r - 1) {
             std::construct_at(root + pos - 1, *begin++, l);
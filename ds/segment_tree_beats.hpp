@@ -0,0 +1,362 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#ifndef INFLATE_SEGMENT_TREE_BEATS_HPP
+#define INFLATE_SEGMENT_TREE_BEATS_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+
+#include "instrumentation.hpp"
+
+namespace inflate {
+
+    template <class T>
+    struct segment_tree_beats_node {
+
+        using size_type = std::size_t;
+
+        T sum;
+        T max;
+        T second_max;
+        size_type max_count;
+        T min;
+        T second_min;
+        size_type min_count;
+        size_type begin_pos;
+        size_type end_pos;
+
+        [[nodiscard]] constexpr bool is_leaf() const noexcept {
+            return begin_pos == end_pos-1;
+        }
+
+        // construct leaf node
+        constexpr segment_tree_beats_node(const T& val, size_type pos):
+                sum(val),
+                max(val),
+                second_max(std::numeric_limits<T>::lowest()),
+                max_count(1),
+                min(val),
+                second_min(std::numeric_limits<T>::max()),
+                min_count(1),
+                begin_pos(pos),
+                end_pos(pos + 1) {}
+
+        constexpr segment_tree_beats_node(const segment_tree_beats_node& l_child, const segment_tree_beats_node& r_child):
+                sum(l_child.sum + r_child.sum),
+                begin_pos(l_child.begin_pos),
+                end_pos(r_child.end_pos) {
+            if (l_child.max == r_child.max) {
+                max = l_child.max;
+                second_max = std::max(l_child.second_max, r_child.second_max);
+                max_count = l_child.max_count + r_child.max_count;
+            } else if (l_child.max > r_child.max) {
+                max = l_child.max;
+                second_max = std::max(l_child.second_max, r_child.max);
+                max_count = l_child.max_count;
+            } else {
+                max = r_child.max;
+                second_max = std::max(l_child.max, r_child.second_max);
+                max_count = r_child.max_count;
+            }
+
+            if (l_child.min == r_child.min) {
+                min = l_child.min;
+                second_min = std::min(l_child.second_min, r_child.second_min);
+                min_count = l_child.min_count + r_child.min_count;
+            } else if (l_child.min < r_child.min) {
+                min = l_child.min;
+                second_min = std::min(l_child.second_min, r_child.min);
+                min_count = l_child.min_count;
+            } else {
+                min = r_child.min;
+                second_min = std::min(l_child.min, r_child.second_min);
+                min_count = r_child.min_count;
+            }
+        }
+
+        // Lower every maximum to x. Only valid while second_max < x, so the maxima stay one group
+        constexpr void apply_chmin(const T& x) {
+            if (x >= max) {
+                return;
+            }
+            sum -= (max - x) * static_cast<T>(max_count);
+            if (min == max) {
+                min = x;
+            } else if (second_min == max) {
+                second_min = x;
+            }
+            max = x;
+        }
+
+        // Raise every minimum to x. Only valid while second_min > x, so the minima stay one group
+        constexpr void apply_chmax(const T& x) {
+            if (x <= min) {
+                return;
+            }
+            sum += (x - min) * static_cast<T>(min_count);
+            if (max == min) {
+                max = x;
+            } else if (second_max == min) {
+                second_max = x;
+            }
+            min = x;
+        }
+    };
+
+
+    template <class T, class Alloc = std::allocator<segment_tree_beats_node<T>>>
+    concept segment_tree_beats_requirement = std::regular<T>
+                                             && std::totally_ordered<T>
+                                             && std::numeric_limits<T>::is_specialized
+                                             && std::same_as<segment_tree_beats_node<T>, typename Alloc::value_type>
+                                             && requires(T a, T b, std::size_t n) {
+                                                 {a + b} -> std::convertible_to<T>;
+                                                 {a - b} -> std::convertible_to<T>;
+                                                 {a * static_cast<T>(n)} -> std::convertible_to<T>;
+                                             };
+
+    /*
+     * Ji's segment tree beats: range chmin / chmax (a[i] = min(a[i], x) / max(a[i], x)) together
+     * with range sum, max and min queries, in amortized O(log^2 n) per operation.
+     *
+     * A node stores its maximum, strict second maximum and the count of maxima (and the same for
+     * minima). A chmin only has to recurse below a fully covered node while x <= second_max;
+     * otherwise it lowers the maxima in place. A leaf has no second maximum (its second_max is
+     * numeric_limits<T>::lowest(), which x may equal), so a leaf is always updated in place.
+     * Children are brought up to date lazily by clamping them to their parent's extrema, so no
+     * separate tag is needed.
+     *
+     * Sums are kept in T and adjusted by (max - x) * count on every clamp, so neither those
+     * differences nor any range sum may overflow T.
+     */
+    template <
+            class T,
+            class Alloc = std::allocator<segment_tree_beats_node<T>>,
+            class Instrumentation = no_instrumentation
+                    >
+            requires segment_tree_beats_requirement<T, Alloc>
+                     && instrumentation_policy<Instrumentation>
+
+    class segment_tree_beats {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using allocator_type = Alloc;
+        using node_type = segment_tree_beats_node<T>;
+        using instrumentation_type = Instrumentation;
+    protected:
+        Alloc allocator;
+        size_type _size;
+        node_type* root;
+        [[no_unique_address]] mutable Instrumentation instrumentation;
+
+        template<std::input_iterator Iter>
+        Iter buildTree(size_type pos, size_type l, size_type r, Iter begin, Iter end);
+
+        void destroy_tree(size_type pos = 1) noexcept {
+            auto& node = root[pos - 1];
+            if (not node.is_leaf()) {
+                destroy_tree(pos * 2);
+                destroy_tree(pos * 2 + 1);
+            }
+            std::destroy_at(root + pos - 1);
+        }
+
+    public:
+
+        [[nodiscard]] constexpr allocator_type get_allocator() const noexcept {
+            return allocator;
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept {
+            return _size;
+        }
+
+        [[nodiscard]] constexpr size_type allocation_size() const noexcept {
+            return _size*4;
+        }
+
+        [[nodiscard]] constexpr const node_type& root_node () const noexcept {
+            return *root;
+        }
+
+        [[nodiscard]] constexpr instrumentation_snapshot stats() const noexcept {
+            return instrumentation.snapshot();
+        }
+
+        constexpr void reset_stats() noexcept {
+            instrumentation.reset();
+        }
+
+        template<std::input_iterator Iter>
+        constexpr segment_tree_beats(Iter begin, Iter end, const Alloc& alloc = Alloc()):
+        allocator(alloc), _size(std::distance(begin, end)) {
+            root = allocator.allocate(allocation_size());
+            instrumentation.on_allocation(allocation_size() * sizeof(node_type));
+            buildTree(1, 0, _size, begin, end);
+        };
+
+        constexpr segment_tree_beats(const segment_tree_beats& other):
+            allocator(std::allocator_traits<allocator_type>::select_on_container_copy_construction(
+                    other.get_allocator()
+                    )),
+            _size(other._size) {
+            root = allocator.allocate(allocation_size());
+            instrumentation.on_allocation(allocation_size() * sizeof(node_type));
+            std::uninitialized_copy_n(other.root, other.allocation_size(), root);
+        }
+
+        constexpr ~segment_tree_beats() noexcept {
+            destroy_tree();
+            if (this -> _size != 0) {
+                allocator.deallocate(root, allocation_size());
+            }
+        }
+
+        void push_down_tag(size_type pos) {
+            auto& node = root[pos - 1];
+
+            if (node.is_leaf()) {
+                return;
+            }
+
+            _push_to(node, root[pos * 2 - 1]);
+            _push_to(node, root[pos * 2]);
+        }
+
+    private:
+
+        void _push_to(const node_type& parent, node_type& child) {
+            if (child.max > parent.max || child.min < parent.min) {
+                instrumentation.on_push_down();
+                child.apply_chmin(parent.max);
+                child.apply_chmax(parent.min);
+            }
+        }
+
+        void pull_up(size_type pos) {
+            root[pos - 1] = node_type(root[pos * 2 - 1], root[pos * 2]);
+        }
+
+        void _chmin(size_type pos, size_type begin, size_type end, const T& x) {
+            instrumentation.on_node_visit();
+            auto& node = root[pos - 1];
+
+            if (node.max <= x) {
+                return;
+            } else if (node.begin_pos >= begin && node.end_pos <= end && (node.is_leaf() || node.second_max < x)) {
+                node.apply_chmin(x);
+                return;
+            }
+
+            push_down_tag(pos);
+            if (size_type mid = std::midpoint(node.begin_pos, node.end_pos); mid <= begin) {
+                _chmin(pos * 2 + 1, begin, end, x);
+            } else if (mid >= end) {
+                _chmin(pos * 2, begin, end, x);
+            } else {
+                _chmin(pos * 2, begin, end, x);
+                _chmin(pos * 2 + 1, begin, end, x);
+            }
+            pull_up(pos);
+        }
+
+        void _chmax(size_type pos, size_type begin, size_type end, const T& x) {
+            instrumentation.on_node_visit();
+            auto& node = root[pos - 1];
+
+            if (node.min >= x) {
+                return;
+            } else if (node.begin_pos >= begin && node.end_pos <= end && (node.is_leaf() || node.second_min > x)) {
+                node.apply_chmax(x);
+                return;
+            }
+
+            push_down_tag(pos);
+            if (size_type mid = std::midpoint(node.begin_pos, node.end_pos); mid <= begin) {
+                _chmax(pos * 2 + 1, begin, end, x);
+            } else if (mid >= end) {
+                _chmax(pos * 2, begin, end, x);
+            } else {
+                _chmax(pos * 2, begin, end, x);
+                _chmax(pos * 2 + 1, begin, end, x);
+            }
+            pull_up(pos);
+        }
+
+        template<class Get, class Combine>
+        T _query(size_type pos, size_type begin_pos, size_type end_pos, const Get& get, const Combine& combine) {
+            instrumentation.on_node_visit();
+            auto& node = root[pos - 1];
+
+            if (node.begin_pos >= begin_pos && node.end_pos <= end_pos) {
+                return std::invoke(get, node);
+            }
+
+            push_down_tag(pos);
+            if (size_type mid = std::midpoint(node.begin_pos, node.end_pos); mid <= begin_pos) {
+                return _query(pos * 2 + 1, begin_pos, end_pos, get, combine);
+            } else if (mid >= end_pos) {
+                return _query(pos * 2, begin_pos, end_pos, get, combine);
+            } else {
+                return std::invoke(combine,
+                                   _query(pos * 2, begin_pos, end_pos, get, combine),
+                                   _query(pos * 2 + 1, begin_pos, end_pos, get, combine));
+            }
+        }
+
+    public:
+        // a[i] = min(a[i], x) for i in [begin, end)
+        void chmin(size_type begin, size_type end, const T& x) {
+            _chmin(1, begin, end, x);
+        }
+
+        // a[i] = max(a[i], x) for i in [begin, end)
+        void chmax(size_type begin, size_type end, const T& x) {
+            _chmax(1, begin, end, x);
+        }
+
+        T query_sum(size_type begin_pos, size_type end_pos) {
+            return _query(1, begin_pos, end_pos, &node_type::sum, std::plus<T>());
+        }
+
+        T query_max(size_type begin_pos, size_type end_pos) {
+            return _query(1, begin_pos, end_pos, &node_type::max,
+                          [](const T& a, const T& b) { return std::max(a, b); });
+        }
+
+        T query_min(size_type begin_pos, size_type end_pos) {
+            return _query(1, begin_pos, end_pos, &node_type::min,
+                          [](const T& a, const T& b) { return std::min(a, b); });
+        }
+    };
+
+    template<class T, class Alloc, class Instrumentation>
+    requires segment_tree_beats_requirement<T, Alloc>
+             && instrumentation_policy<Instrumentation>
+    template<std::input_iterator Iter>
+    Iter segment_tree_beats<T, Alloc, Instrumentation>
+            ::buildTree(size_type pos, size_type l, size_type r, Iter begin, Iter end) {
+        if (l == r - 1) {
+            std::construct_at(root + pos - 1, *begin++, l);
+            return begin;
+        } else {
+            size_type mid = std::midpoint(l, r);
+            begin = buildTree(pos * 2, l, mid, begin, end);
+            begin = buildTree(pos * 2 + 1, mid, r, begin, end);
+
+            std::construct_at(root + pos - 1, root[pos * 2 - 1], root[pos * 2]);
+
+            return begin;
+        }
+    }
+
+} // inflate
+
+#endif //INFLATE_SEGMENT_TREE_BEATS_HPP
@@ -0,0 +1,190 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#ifndef INFLATE_SHARDED_SEGMENT_TREE_HPP
+#define INFLATE_SHARDED_SEGMENT_TREE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "segment_tree.hpp"
+
+namespace inflate {
+
+    template <
+            class T,
+            class Plus = std::plus<T>,
+            class OperationOperandType = T,
+            class Alloc = std::allocator<segment_tree_node<T, OperationOperandType>>,
+            class Instrumentation = no_instrumentation
+                    >
+    concept sharded_segment_tree_requirement = linear_segment_tree_requirement<T, Plus, OperationOperandType, Alloc>
+                                               && instrumentation_policy<Instrumentation>
+                                               && std::is_trivially_copyable_v<T>;
+
+    /*
+     * linear_segment_tree split into contiguous shards, each guarded by its own mutex, so writers
+     * touching disjoint shards never contend.
+     *
+     * Every shard publishes its total through an atomic after each write. A query that fully
+     * covers a shard reads that atomic instead of taking the lock, so query(0, size()) is a
+     * lock-free fold over shard_count() values. Plus must be associative; shards are folded left
+     * to right, so it need not be commutative.
+     *
+     * Updates are linearizable per shard only: a range spanning several shards is applied shard by
+     * shard, and a concurrent query may observe it half done. Register every operation before the
+     * tree is shared between threads.
+     */
+    template <
+            class T,
+            class Plus = std::plus<T>,
+            class OperationOperandType = T,
+            class Alloc = std::allocator<segment_tree_node<T, OperationOperandType>>,
+            class Instrumentation = no_instrumentation
+                    >
+            requires sharded_segment_tree_requirement<T, Plus, OperationOperandType, Alloc, Instrumentation>
+
+    class sharded_segment_tree {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using allocator_type = Alloc;
+        using shard_tree_type = linear_segment_tree<T, Plus, OperationOperandType, Alloc, Instrumentation>;
+    protected:
+        struct shard {
+            mutable std::mutex mutex;
+            shard_tree_type tree;
+            std::atomic<T> sum;
+            size_type begin_pos;
+            size_type end_pos;
+
+            template<std::forward_iterator Iter>
+            shard(Iter begin, Iter end, size_type _begin_pos, const Alloc& alloc):
+                tree(begin, end, alloc),
+                sum(tree.root_node().sum),
+                begin_pos(_begin_pos),
+                end_pos(_begin_pos + tree.size()) {}
+        };
+
+        // Shard trees count positions from 0; shift them back so operations see global positions
+        template<class Call>
+        struct offset_operation {
+            Call operation;
+            size_type offset;
+
+            T operator()(const T& a, const OperationOperandType& val, size_t begin_pos, size_t end_pos) const {
+                return std::invoke(operation, a, val, begin_pos + offset, end_pos + offset);
+            }
+        };
+
+        size_type _size;
+        size_type shard_width;
+        std::vector<std::unique_ptr<shard>> shards;
+
+        [[nodiscard]] constexpr size_type first_shard(size_type begin_pos) const noexcept {
+            return begin_pos / shard_width;
+        }
+
+        [[nodiscard]] constexpr size_type last_shard(size_type end_pos) const noexcept {
+            return (end_pos - 1) / shard_width;
+        }
+
+    public:
+
+        [[nodiscard]] constexpr size_type size() const noexcept {
+            return _size;
+        }
+
+        [[nodiscard]] size_type shard_count() const noexcept {
+            return shards.size();
+        }
+
+        template<std::forward_iterator Iter>
+        sharded_segment_tree(Iter begin, Iter end,
+                             size_type shard_count = std::max(1u, std::thread::hardware_concurrency()),
+                             const Alloc& alloc = Alloc()):
+        _size(std::distance(begin, end)) {
+            // Every shard needs at least one element, and shard_width must not be 0
+            if (_size == 0)
+                throw std::out_of_range("Empty range!");
+            shard_count = std::clamp<size_type>(shard_count, 1, _size);
+            shard_width = (_size + shard_count - 1) / shard_count;
+            shards.reserve(shard_count);
+            for (size_type pos = 0; pos < _size; pos += shard_width) {
+                auto shard_end = std::next(begin, std::min(shard_width, _size - pos));
+                shards.push_back(std::make_unique<shard>(begin, shard_end, pos, alloc));
+                begin = shard_end;
+            }
+        }
+
+        sharded_segment_tree(const sharded_segment_tree&) = delete;
+        sharded_segment_tree& operator=(const sharded_segment_tree&) = delete;
+
+        template<class Call> requires std::copyable<Call> && std::is_invocable_r_v<T, Call, const T&, const OperationOperandType&, size_t, size_t>
+        void add_operation(Call operation) {
+            for (auto& s : shards) {
+                std::scoped_lock lock(s->mutex);
+                s->tree.add_operation(offset_operation<Call>{operation, s->begin_pos});
+            }
+        }
+
+        void update(size_type begin, size_type end, int operation_num, const OperationOperandType& val) {
+            for (size_type i = first_shard(begin), last = last_shard(end); i <= last; ++i) {
+                auto& s = *shards[i];
+                std::scoped_lock lock(s.mutex);
+                s.tree.update(std::max(begin, s.begin_pos) - s.begin_pos,
+                              std::min(end, s.end_pos) - s.begin_pos,
+                              operation_num, val);
+                s.sum.store(s.tree.root_node().sum, std::memory_order_release);
+            }
+        }
+
+        T query(size_type begin_pos, size_type end_pos, const Plus& plus = Plus()) {
+            std::optional<T> result;
+            for (size_type i = first_shard(begin_pos), last = last_shard(end_pos); i <= last; ++i) {
+                auto& s = *shards[i];
+                T part = [&] {
+                    if (begin_pos <= s.begin_pos && s.end_pos <= end_pos) {
+                        return s.sum.load(std::memory_order_acquire);
+                    }
+                    std::scoped_lock lock(s.mutex);
+                    return s.tree.query(std::max(begin_pos, s.begin_pos) - s.begin_pos,
+                                        std::min(end_pos, s.end_pos) - s.begin_pos,
+                                        plus);
+                }();
+                result = result.has_value() ? std::invoke(plus, *result, part) : part;
+            }
+            return *result;
+        }
+
+        // Counters of every shard added together
+        [[nodiscard]] instrumentation_snapshot stats() const {
+            instrumentation_snapshot total;
+            for (const auto& s : shards) {
+                std::scoped_lock lock(s->mutex);
+                total += s->tree.stats();
+            }
+            return total;
+        }
+
+        void reset_stats() {
+            for (auto& s : shards) {
+                std::scoped_lock lock(s->mutex);
+                s->tree.reset_stats();
+            }
+        }
+    };
+
+} // inflate
+
+#endif //INFLATE_SHARDED_SEGMENT_TREE_HPP
@@ -0,0 +1,99 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#include "../ds/segment_tree.hpp"
+#include "../ds/order_statistics_tree.hpp"
+#include "../ds/partial_sum_series.hpp"
+#include <gtest/gtest.h>
+#include <bit>
+#include <numeric>
+#include <vector>
+
+using counted_segment_tree = inflate::linear_segment_tree<
+        int, std::plus<int>, int, std::allocator<inflate::segment_tree_node<int, int>>,
+        inflate::counting_instrumentation>;
+
+static_assert(sizeof(inflate::order_statistics_tree<int>)
+              < sizeof(inflate::order_statistics_tree<int, inflate::counting_instrumentation>));
+
+TEST(InstrumentationTestSuite, DisabledPolicyReportsNothing) {
+    std::vector a = {1, 2, 3, 4, 5};
+    inflate::linear_segment_tree<int> tree(a.begin(), a.end());
+    tree.add_operation([](int a, int b, size_t begin_pos, size_t end_pos) {return a + b * (end_pos - begin_pos);});
+    tree.update(1, 4, 0, 2);
+    ASSERT_EQ(tree.query(0, 5), 21);
+    ASSERT_EQ(tree.stats(), inflate::instrumentation_snapshot{});
+}
+
+TEST(InstrumentationTestSuite, SegmentTreeAllocationTest) {
+    std::vector a = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    counted_segment_tree tree(a.begin(), a.end());
+    auto stats = tree.stats();
+    ASSERT_EQ(stats.allocations, 1);
+    ASSERT_EQ(stats.bytes_allocated, tree.allocation_size() * sizeof(counted_segment_tree::node_type));
+    ASSERT_EQ(stats.node_visits, 0);
+}
+
+TEST(InstrumentationTestSuite, SegmentTreeLogarithmicVisitsTest) {
+    constexpr size_t n = 1 << 12;
+    constexpr size_t depth = std::bit_width(n);
+    std::vector<int> a(n);
+    std::iota(a.begin(), a.end(), 0);
+    counted_segment_tree tree(a.begin(), a.end());
+    tree.add_operation([](int a, int b, size_t begin_pos, size_t end_pos) {return a + b * (end_pos - begin_pos);});
+
+    for (size_t l = 1; l < n; l += 97) {
+        tree.reset_stats();
+        tree.update(l / 2, l, 0, 1);
+        ASSERT_LE(tree.stats().node_visits, 4 * depth);
+        tree.reset_stats();
+        tree.query(l / 3, l);
+        ASSERT_LE(tree.stats().node_visits, 4 * depth);
+    }
+}
+
+TEST(InstrumentationTestSuite, SegmentTreePushDownTest) {
+    std::vector a = {1, 2, 3, 4, 5, 6, 7, 8};
+    counted_segment_tree tree(a.begin(), a.end());
+    tree.add_operation([](int a, int b, size_t begin_pos, size_t end_pos) {return a + b * (end_pos - begin_pos);});
+    tree.update(0, 8, 0, 1);
+    ASSERT_EQ(tree.stats().push_downs, 0);
+    tree.query(0, 1);
+    ASSERT_EQ(tree.stats().push_downs, 3);
+}
+
+TEST(InstrumentationTestSuite, OrderStatisticsTreeTest) {
+    inflate::order_statistics_tree<int, inflate::counting_instrumentation> tree;
+    for (int i = 0; i < 1024; ++i) {
+        tree.insert(i);
+    }
+    auto stats = tree.stats();
+    ASSERT_EQ(stats.allocations, 1024);
+    ASSERT_EQ(stats.bytes_allocated, 1024 * sizeof(inflate::rb_tree_node<int>));
+    // ascending inserts keep hitting the right spine and must rebalance
+    ASSERT_GT(stats.rotations, 0);
+
+    // rejected duplicates never allocate
+    tree.reset_stats();
+    tree.insert(0);
+    tree.insert(512);
+    ASSERT_EQ(tree.stats().allocations, 0);
+    ASSERT_EQ(tree.stats().bytes_allocated, 0);
+    ASSERT_EQ(tree.getSize(), 1024);
+
+    tree.reset_stats();
+    ASSERT_EQ(tree.kthSmallest(1), 0);
+    ASSERT_EQ(tree.kthSmallest(1024), 1023);
+    // a red-black tree is at most 2 * log2(n + 1) deep
+    ASSERT_LE(tree.stats().node_visits, 2 * 2 * 11);
+}
+
+TEST(InstrumentationTestSuite, PartialSumSeriesTest) {
+    std::vector a = {1, 2, 3, 4, 5};
+    inflate::partial_sum_series<int, std::plus<int>, std::minus<int>, inflate::counting_instrumentation>
+            series(a.begin(), a.end());
+    ASSERT_EQ(series.stats().bytes_allocated, a.size() * sizeof(int));
+    ASSERT_EQ(series.query(series.cbegin(), series.cbegin() + 4), 14);
+    ASSERT_EQ(series.stats().node_visits, 2);
+}
@@ -0,0 +1,141 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#include "../ds/mo_query_engine.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+    struct distinct_state {
+        std::vector<int> count;
+        int distinct = 0;
+    };
+
+    auto distinct_add = [](distinct_state& s, int v) {
+        if (s.count[v]++ == 0) ++s.distinct;
+    };
+    auto distinct_remove = [](distinct_state& s, int v) {
+        if (--s.count[v] == 0) --s.distinct;
+    };
+    auto distinct_answer = [](const distinct_state& s) { return s.distinct; };
+
+    // Largest multiplicity in the window; freq_count[f] counts values seen exactly f times
+    struct mode_state {
+        std::vector<int> count;
+        std::vector<int> freq_count;
+        int mode = 0;
+    };
+
+    auto mode_add = [](mode_state& s, int v) {
+        --s.freq_count[s.count[v]];
+        ++s.freq_count[++s.count[v]];
+        s.mode = std::max(s.mode, s.count[v]);
+    };
+    auto mode_remove = [](mode_state& s, int v) {
+        if (s.count[v] == s.mode && s.freq_count[s.mode] == 1) --s.mode;
+        --s.freq_count[s.count[v]];
+        ++s.freq_count[--s.count[v]];
+    };
+    auto mode_answer = [](const mode_state& s) { return s.mode; };
+
+    std::vector<std::pair<size_t, size_t>> random_queries(size_t n, size_t q, std::mt19937& gen) {
+        std::uniform_int_distribution<size_t> position(0, n);
+        std::vector<std::pair<size_t, size_t>> queries(q);
+        for (auto& [l, r] : queries) {
+            l = position(gen);
+            r = position(gen);
+            if (l > r) std::swap(l, r);
+        }
+        return queries;
+    }
+
+}
+
+TEST(MoQueryEngineTestSuite, DistinctCountTest) {
+    std::vector a = {1, 2, 1, 3, 2, 2, 4};
+    inflate::mo_query_engine<int> engine(a.begin(), a.end());
+    ASSERT_EQ(engine.size(), a.size());
+    std::vector<std::pair<size_t, size_t>> queries = {{0, 7}, {0, 3}, {2, 6}, {4, 6}, {3, 3}, {6, 7}};
+    auto results = engine.solve(queries, distinct_state{std::vector<int>(5)},
+                                distinct_add, distinct_remove, distinct_answer);
+    ASSERT_EQ(results, (std::vector<int>{4, 2, 3, 1, 0, 1}));
+}
+
+TEST(MoQueryEngineTestSuite, InvalidQueryTest) {
+    std::vector a = {1, 2, 3};
+    inflate::mo_query_engine<int> engine(a.begin(), a.end());
+    ASSERT_THROW(engine.solve(std::vector<std::pair<size_t, size_t>>{{2, 1}}, distinct_state{std::vector<int>(4)},
+                              distinct_add, distinct_remove, distinct_answer), std::out_of_range);
+    ASSERT_THROW(engine.solve(std::vector<std::pair<size_t, size_t>>{{0, 4}}, distinct_state{std::vector<int>(4)},
+                              distinct_add, distinct_remove, distinct_answer), std::out_of_range);
+}
+
+TEST(MoQueryEngineTestSuite, RandomizedAgainstNaiveTest) {
+    constexpr size_t n = 500;
+    constexpr int values = 40;
+    std::mt19937 gen(20231018);
+    std::vector<int> a(n);
+    std::generate(a.begin(), a.end(), [&] { return static_cast<int>(gen() % values); });
+    const auto queries = random_queries(n, 800, gen);
+
+    std::vector<int> expected_distinct, expected_mode;
+    for (const auto& [l, r] : queries) {
+        std::vector<int> count(values);
+        for (size_t i = l; i < r; ++i) ++count[a[i]];
+        expected_distinct.push_back(static_cast<int>(std::count_if(count.begin(), count.end(), [](int c) { return c > 0; })));
+        expected_mode.push_back(*std::max_element(count.begin(), count.end()));
+    }
+
+    inflate::mo_query_engine<int> engine(a.begin(), a.end());
+    for (auto order : {inflate::mo_order::block, inflate::mo_order::hilbert}) {
+        for (size_t threads : {1, 3, 8}) {
+            ASSERT_EQ(engine.solve(queries, distinct_state{std::vector<int>(values)},
+                                   distinct_add, distinct_remove, distinct_answer, order, threads),
+                      expected_distinct);
+            ASSERT_EQ(engine.solve(queries, mode_state{std::vector<int>(values), std::vector<int>(n + 1)},
+                                   mode_add, mode_remove, mode_answer, order, threads),
+                      expected_mode);
+        }
+    }
+}
+
+TEST(MoQueryEngineTestSuite, BoolResultsTest) {
+    constexpr size_t n = 2000;
+    std::mt19937 gen(7);
+    std::vector<int> a(n);
+    std::generate(a.begin(), a.end(), [&] { return static_cast<int>(gen() % 50); });
+    const auto queries = random_queries(n, 3000, gen);
+
+    inflate::mo_query_engine<int> engine(a.begin(), a.end());
+    auto many_distinct = [](const distinct_state& s) { return s.distinct > 10; };
+    auto expected = engine.solve(queries, distinct_state{std::vector<int>(50)},
+                                 distinct_add, distinct_remove, many_distinct);
+    ASSERT_EQ(engine.solve(queries, distinct_state{std::vector<int>(50)},
+                           distinct_add, distinct_remove, many_distinct, inflate::mo_order::hilbert, 8),
+              expected);
+}
+
+TEST(MoQueryEngineTestSuite, CallbackExceptionTest) {
+    std::vector<int> a(100);
+    std::iota(a.begin(), a.end(), 0);
+    inflate::mo_query_engine<int> engine(a.begin(), a.end());
+    std::vector<std::pair<size_t, size_t>> queries;
+    for (size_t l = 0; l < 100; l += 5) {
+        queries.emplace_back(l, 100);
+    }
+    auto throwing_add = [](int& sum, int v) {
+        if (v == 42) throw std::runtime_error("bad value");
+        sum += v;
+    };
+    auto remove = [](int& sum, int v) { sum -= v; };
+    auto answer = [](const int& sum) { return sum; };
+    for (size_t threads : {1, 4}) {
+        ASSERT_THROW(engine.solve(queries, 0, throwing_add, remove, answer, inflate::mo_order::block, threads),
+                     std::runtime_error);
+    }
+}
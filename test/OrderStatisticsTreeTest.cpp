@@ -0,0 +1,95 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#include "../ds/order_statistics_tree.hpp"
+#include <gtest/gtest.h>
+#include <iterator>
+#include <random>
+#include <set>
+
+namespace {
+
+    template <class T>
+    int child_count(const inflate::rb_tree_node<T>* node) {
+        return (node->left != nullptr) + (node->right != nullptr);
+    }
+
+    template <class Tree>
+    void expect_matches(const Tree& tree, const std::set<int>& expected) {
+        ASSERT_EQ(tree.getSize(), static_cast<int>(expected.size()));
+        int k = 1;
+        for (const auto& value : expected) {
+            ASSERT_EQ(tree.kthSmallest(k++), value);
+        }
+    }
+
+}
+
+TEST(OrderStatisticsTreeTestSuite, InsertDuplicateTest) {
+    inflate::order_statistics_tree<int> tree;
+    for (int v : {5, 3, 8, 3, 5, 8, 1}) {
+        tree.insert(v);
+    }
+    expect_matches(tree, {1, 3, 5, 8});
+    ASSERT_THROW(tree.kthSmallest(0), std::out_of_range);
+    ASSERT_THROW(tree.kthSmallest(5), std::out_of_range);
+}
+
+TEST(OrderStatisticsTreeTestSuite, RemoveByChildCountTest) {
+    inflate::order_statistics_tree<int> tree;
+    std::set<int> expected = {4, 2, 6, 1, 3, 5, 7};
+    for (int v : {4, 2, 6, 1, 3, 5, 7}) {
+        tree.insert(v);
+    }
+
+    ASSERT_EQ(child_count(tree.find(1)), 0);
+    tree.remove(1);
+    expected.erase(1);
+    ASSERT_EQ(tree.find(1), nullptr);
+    expect_matches(tree, expected);
+
+    ASSERT_EQ(child_count(tree.find(2)), 1);
+    tree.remove(2);
+    expected.erase(2);
+    expect_matches(tree, expected);
+
+    ASSERT_EQ(child_count(tree.find(6)), 2);
+    tree.remove(6);
+    expected.erase(6);
+    expect_matches(tree, expected);
+
+    tree.remove(42);
+    expect_matches(tree, expected);
+
+    for (int v : {3, 4, 5, 7}) {
+        tree.remove(v);
+    }
+    ASSERT_EQ(tree.getSize(), 0);
+    tree.insert(9);
+    expect_matches(tree, {9});
+}
+
+TEST(OrderStatisticsTreeTestSuite, RandomizedAgainstSetTest) {
+    std::mt19937 gen(20231018);
+    std::uniform_int_distribution<int> value(0, 499);
+    inflate::order_statistics_tree<int> tree;
+    std::set<int> expected;
+
+    for (int i = 0; i < 20000; ++i) {
+        int v = value(gen);
+        if (gen() % 2) {
+            tree.insert(v);
+            expected.insert(v);
+        } else {
+            tree.remove(v);
+            expected.erase(v);
+        }
+        ASSERT_EQ(tree.getSize(), static_cast<int>(expected.size()));
+        if (!expected.empty()) {
+            int k = static_cast<int>(gen() % expected.size()) + 1;
+            ASSERT_EQ(tree.kthSmallest(k), *std::next(expected.begin(), k - 1));
+        }
+    }
+    expect_matches(tree, expected);
+}
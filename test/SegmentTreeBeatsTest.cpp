@@ -0,0 +1,110 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#include "../ds/segment_tree_beats.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+TEST(SegmentTreeBeatsTestSuite, ConstructionFromIteratorRangeTest) {
+    std::vector a = {5, 1, 5, 3, 2};
+    inflate::segment_tree_beats<int> tree(a.begin(), a.end());
+    ASSERT_EQ(tree.size(), a.size());
+    const auto& root = tree.root_node();
+    ASSERT_EQ(root.sum, 16);
+    ASSERT_EQ(root.max, 5);
+    ASSERT_EQ(root.max_count, 2);
+    ASSERT_EQ(root.second_max, 3);
+    ASSERT_EQ(root.min, 1);
+    ASSERT_EQ(root.min_count, 1);
+    ASSERT_EQ(root.second_min, 2);
+}
+
+TEST(SegmentTreeBeatsTestSuite, ChminChmaxTest) {
+    std::vector a = {1, 5, 4, 2, 3};
+    inflate::segment_tree_beats<int> tree(a.begin(), a.end());
+    tree.chmin(0, 5, 3);
+    ASSERT_EQ(tree.query_sum(0, 5), 12);
+    ASSERT_EQ(tree.query_max(0, 5), 3);
+    tree.chmax(1, 4, 4);
+    // {1, 4, 4, 4, 3}
+    ASSERT_EQ(tree.query_sum(0, 5), 16);
+    ASSERT_EQ(tree.query_min(0, 5), 1);
+    ASSERT_EQ(tree.query_min(1, 5), 3);
+    ASSERT_EQ(tree.query_max(4, 5), 3);
+    tree.chmin(2, 3, 0);
+    // {1, 4, 0, 4, 3}
+    ASSERT_EQ(tree.query_sum(1, 4), 8);
+    ASSERT_EQ(tree.query_min(0, 5), 0);
+}
+
+TEST(SegmentTreeBeatsTestSuite, RandomizedAgainstNaiveTest) {
+    constexpr size_t n = 257;
+    std::mt19937 gen(20231018);
+    std::uniform_int_distribution<long long> value(-1000, 1000);
+    std::uniform_int_distribution<size_t> position(0, n - 1);
+
+    std::vector<long long> a(n);
+    std::generate(a.begin(), a.end(), [&] { return value(gen); });
+    inflate::segment_tree_beats<long long> tree(a.begin(), a.end());
+
+    for (int i = 0; i < 5000; ++i) {
+        auto l = position(gen), r = position(gen);
+        if (l > r) std::swap(l, r);
+        ++r;
+        auto x = value(gen);
+        switch (gen() % 5) {
+            case 0:
+                tree.chmin(l, r, x);
+                std::for_each(a.begin() + l, a.begin() + r, [&](auto& v) { v = std::min(v, x); });
+                break;
+            case 1:
+                tree.chmax(l, r, x);
+                std::for_each(a.begin() + l, a.begin() + r, [&](auto& v) { v = std::max(v, x); });
+                break;
+            case 2:
+                ASSERT_EQ(tree.query_sum(l, r), std::accumulate(a.begin() + l, a.begin() + r, 0LL));
+                break;
+            case 3:
+                ASSERT_EQ(tree.query_max(l, r), *std::max_element(a.begin() + l, a.begin() + r));
+                break;
+            default:
+                ASSERT_EQ(tree.query_min(l, r), *std::min_element(a.begin() + l, a.begin() + r));
+                break;
+        }
+    }
+}
+
+TEST(SegmentTreeBeatsTestSuite, CopyConstructionTest) {
+    std::vector a = {3, 1, 4, 1, 5, 9, 2, 6};
+    inflate::segment_tree_beats<int> tree(a.begin(), a.end());
+    tree.chmin(0, 8, 4);
+    inflate::segment_tree_beats<int> copy(tree);
+    copy.chmax(0, 8, 3);
+    ASSERT_EQ(tree.query_sum(0, 8), 23);
+    ASSERT_EQ(copy.query_sum(0, 8), 28);
+}
+
+TEST(SegmentTreeBeatsTestSuite, ClampToNumericLimitsTest) {
+    std::vector<unsigned> a = {3, 5, 7, 9};
+    inflate::segment_tree_beats<unsigned> counters(a.begin(), a.end());
+    counters.chmin(1, 4, 0u);
+    ASSERT_EQ(counters.query_sum(0, 4), 3u);
+    ASSERT_EQ(counters.query_max(1, 4), 0u);
+    counters.chmin(0, 4, 0u);
+    ASSERT_EQ(counters.query_sum(0, 4), 0u);
+
+    // Single-leaf clamps to the int extremes; signs are chosen so no difference or sum overflows
+    std::vector b = {-4, 0, -3, -2};
+    inflate::segment_tree_beats<int> tree(b.begin(), b.end());
+    tree.chmax(1, 2, std::numeric_limits<int>::max());
+    ASSERT_EQ(tree.query_max(0, 4), std::numeric_limits<int>::max());
+    ASSERT_EQ(tree.query_sum(0, 4), std::numeric_limits<int>::max() - 9);
+    tree.chmin(0, 1, std::numeric_limits<int>::lowest());
+    ASSERT_EQ(tree.query_min(0, 4), std::numeric_limits<int>::lowest());
+    ASSERT_EQ(tree.query_sum(0, 2), -1);
+    ASSERT_EQ(tree.query_sum(0, 4), -6);
+}
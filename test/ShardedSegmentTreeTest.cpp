@@ -0,0 +1,183 @@
+//
+// Created by Administrator on 10/18/2023.
+//
+
+#include "../ds/sharded_segment_tree.hpp"
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+    auto range_add = [](long long a, long long b, size_t begin_pos, size_t end_pos) {
+        return a + b * static_cast<long long>(end_pos - begin_pos);
+    };
+
+    // a[i] += b * i, so the result depends on the global position of the range
+    auto weighted_add = [](long long a, long long b, size_t begin_pos, size_t end_pos) {
+        return a + b * static_cast<long long>((begin_pos + end_pos - 1) * (end_pos - begin_pos) / 2);
+    };
+}
+
+TEST(ShardedSegmentTreeTestSuite, ShardLayoutTest) {
+    std::vector a = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    inflate::sharded_segment_tree<int> tree(a.begin(), a.end(), 3);
+    ASSERT_EQ(tree.size(), a.size());
+    ASSERT_EQ(tree.shard_count(), 3);
+    ASSERT_EQ(tree.query(0, 10), 55);
+    ASSERT_EQ(tree.query(3, 5), 9);
+    ASSERT_EQ(tree.query(2, 9), 42);
+
+    inflate::sharded_segment_tree<int> oversharded(a.begin(), a.end(), 64);
+    ASSERT_EQ(oversharded.shard_count(), a.size());
+    ASSERT_EQ(oversharded.query(0, 10), 55);
+}
+
+TEST(ShardedSegmentTreeTestSuite, EmptyRangeTest) {
+    std::vector<int> a;
+    ASSERT_THROW(inflate::sharded_segment_tree<int>(a.begin(), a.end(), 4), std::out_of_range);
+}
+
+TEST(ShardedSegmentTreeTestSuite, MatchesLinearSegmentTreeTest) {
+    constexpr size_t n = 1000;
+    std::mt19937 gen(20231018);
+    std::uniform_int_distribution<size_t> position(0, n - 1);
+    std::vector<long long> a(n);
+    std::iota(a.begin(), a.end(), 0);
+
+    inflate::linear_segment_tree<long long> expected(a.begin(), a.end());
+    inflate::sharded_segment_tree<long long> tree(a.begin(), a.end(), 7);
+    expected.add_operation(range_add);
+    tree.add_operation(range_add);
+
+    for (int i = 0; i < 2000; ++i) {
+        auto l = position(gen), r = position(gen);
+        if (l > r) std::swap(l, r);
+        ++r;
+        if (gen() % 2) {
+            long long val = static_cast<long long>(gen() % 100);
+            expected.update(l, r, 0, val);
+            tree.update(l, r, 0, val);
+        } else {
+            ASSERT_EQ(tree.query(l, r), expected.query(l, r));
+        }
+    }
+    ASSERT_EQ(tree.query(0, n), expected.query(0, n));
+}
+
+TEST(ShardedSegmentTreeTestSuite, DisjointWritersTest) {
+    constexpr size_t threads = 4;
+    constexpr size_t n = 4096;
+    constexpr int rounds = 2000;
+    std::vector<long long> a(n, 0);
+    inflate::sharded_segment_tree<long long> tree(a.begin(), a.end(), threads * 2);
+    tree.add_operation(range_add);
+
+    std::vector<std::thread> writers;
+    for (size_t t = 0; t < threads; ++t) {
+        writers.emplace_back([&tree, t] {
+            // each writer owns one quarter and also issues ranges crossing its shard boundary
+            const size_t begin = t * (n / threads), end = begin + n / threads;
+            for (int i = 0; i < rounds; ++i) {
+                tree.update(begin + i % 7, end - i % 5, 0, 1);
+                tree.update(begin + i % (n / threads), begin + i % (n / threads) + 1, 0, 1);
+                ASSERT_GE(tree.query(0, n), 0);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    long long total = 0;
+    for (int i = 0; i < rounds; ++i) {
+        total += static_cast<long long>(n / threads - i % 7 - i % 5) + 1;
+    }
+    ASSERT_EQ(tree.query(0, n), total * static_cast<long long>(threads));
+}
+
+TEST(ShardedSegmentTreeTestSuite, PositionDependentOperationTest) {
+    std::vector<long long> a(8, 0);
+    inflate::sharded_segment_tree<long long> tree(a.begin(), a.end(), 4);
+    tree.add_operation(weighted_add);
+    tree.update(0, 8, 0, 1);
+    ASSERT_EQ(tree.query(0, 8), 28);
+    ASSERT_EQ(tree.query(5, 7), 11);
+
+    constexpr size_t n = 300;
+    std::mt19937 gen(20231018);
+    std::uniform_int_distribution<size_t> position(0, n - 1);
+    std::vector<long long> b(n, 1);
+    inflate::linear_segment_tree<long long> expected(b.begin(), b.end());
+    inflate::sharded_segment_tree<long long> sharded(b.begin(), b.end(), 7);
+    expected.add_operation(weighted_add);
+    sharded.add_operation(weighted_add);
+    for (int i = 0; i < 1000; ++i) {
+        auto l = position(gen), r = position(gen);
+        if (l > r) std::swap(l, r);
+        ++r;
+        if (gen() % 2) {
+            expected.update(l, r, 0, 2);
+            sharded.update(l, r, 0, 2);
+        } else {
+            ASSERT_EQ(sharded.query(l, r), expected.query(l, r));
+        }
+    }
+}
+
+TEST(ShardedSegmentTreeTestSuite, ContendedWritersAndReadersTest) {
+    constexpr size_t writers = 4, readers = 2;
+    constexpr size_t n = 1000;
+    constexpr int rounds = 3000;
+    std::vector<long long> a(n, 0);
+    inflate::sharded_segment_tree<long long> tree(a.begin(), a.end(), 8);
+    tree.add_operation(range_add);
+
+    std::vector<long long> written(writers, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < writers; ++t) {
+        threads.emplace_back([&, t] {
+            // every writer hits the whole index space, so shards are shared between writers
+            std::mt19937 gen(static_cast<unsigned>(t));
+            std::uniform_int_distribution<size_t> position(0, n - 1);
+            for (int i = 0; i < rounds; ++i) {
+                auto l = position(gen), r = position(gen);
+                if (l > r) std::swap(l, r);
+                ++r;
+                tree.update(l, r, 0, 1);
+                written[t] += static_cast<long long>(r - l);
+            }
+        });
+    }
+    for (size_t t = 0; t < readers; ++t) {
+        threads.emplace_back([&, t] {
+            // values only grow, so a partial query that takes shard locks must never go backwards
+            const size_t l = 37 + t * 200, r = n - 41 - t * 100;
+            long long last = 0;
+            for (int i = 0; i < rounds; ++i) {
+                auto now = tree.query(l, r);
+                ASSERT_GE(now, last);
+                last = now;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(tree.query(0, n), std::accumulate(written.begin(), written.end(), 0LL));
+}
+
+TEST(ShardedSegmentTreeTestSuite, StatsAggregateShardsTest) {
+    std::vector<long long> a(64, 1);
+    inflate::sharded_segment_tree<long long, std::plus<long long>, long long,
+            std::allocator<inflate::segment_tree_node<long long, long long>>,
+            inflate::counting_instrumentation> tree(a.begin(), a.end(), 4);
+    ASSERT_EQ(tree.stats().allocations, 4);
+    // a query covering whole shards never enters a shard tree
+    ASSERT_EQ(tree.query(0, 64), 64);
+    ASSERT_EQ(tree.stats().node_visits, 0);
+    ASSERT_EQ(tree.query(8, 40), 32);
+    ASSERT_GT(tree.stats().node_visits, 0);
+}